@@ -0,0 +1,108 @@
+/**
+ * @file CodificadorPRT7.h
+ * @brief Generación de flujos de tramas PRT-7 con el mínimo número de tramas
+ * @ingroup data_management
+ */
+#ifndef CODIFICADORPRT7_H
+#define CODIFICADORPRT7_H
+
+#include <cstddef>
+
+/**
+ * @class CodificadorPRT7
+ * @brief Convierte texto plano en el flujo PRT-7 más corto que el decodificador ensambla como ese texto.
+ * @details Sigue la semántica de RotorDeMapeo: con la cabeza desplazada k posiciones desde 'A',
+ * una letra X se decodifica como la letra (X + k) mod 26, el espacio se conserva y cualquier otro
+ * carácter pasa sin cambios. Como toda letra se alcanza desde cualquier desplazamiento, el flujo
+ * mínimo tiene exactamente una trama L por carácter y ninguna trama M: el codificador compensa
+ * el desplazamiento actual en cada carácter. Solo se emite una trama M, con el giro de menor
+ * magnitud (RotorDeMapeo::giroMinimo()), cuando se pide dejar el rotor en un desplazamiento
+ * final concreto.
+ *
+ * Los caracteres '\n', '\r' y '\0' no pueden viajar dentro de una trama de texto y se omiten.
+ */
+class CodificadorPRT7 {
+private:
+    int desplazamiento;        ///< Desplazamiento del rotor del decodificador (0..25)
+    int desplazamientoEntrada; ///< Desplazamiento del flujo que se está comprimiendo (0..25)
+    size_t omitidos;           ///< Caracteres de texto que no se pudieron codificar
+    char tabla[256];           ///< Carácter a enviar en la trama L para cada carácter de texto
+
+    /**
+     * @brief Recalcula la tabla de codificación para el desplazamiento actual
+     */
+    void construirTabla();
+
+public:
+    /**
+     * @brief Constructor del codificador
+     * @param desplazamientoInicial Desplazamiento del rotor del decodificador al empezar el flujo
+     * (0 para un decodificador recién creado con la cabeza en 'A')
+     */
+    CodificadorPRT7(int desplazamientoInicial = 0);
+
+    /**
+     * @brief Carácter que produce el rotor para una entrada con un desplazamiento dado
+     * @param entrada Carácter de la trama L
+     * @param desplazamiento Desplazamiento de la cabeza del rotor (0..25)
+     * @return El carácter decodificado, igual que RotorDeMapeo::getMapeo()
+     */
+    static char mapear(char entrada, int desplazamiento);
+
+    /**
+     * @brief Bytes necesarios en el búfer de destino para codificar n caracteres
+     * @param n Cantidad de caracteres de texto
+     * @return Peor caso: todas las tramas son "L,Space\n"
+     */
+    static size_t capacidadNecesaria(size_t n) { return 8 * n; }
+
+    /**
+     * @brief Codifica un bloque de texto como tramas L consecutivas
+     * @details Camino rápido: una consulta a la tabla por carácter, sin recorrer el rotor.
+     * Puede llamarse varias veces para procesar una entrada grande por bloques.
+     * @param texto Caracteres a codificar
+     * @param n Cantidad de caracteres
+     * @param destino Búfer con al menos capacidadNecesaria(n) bytes
+     * @return Bytes escritos en destino
+     */
+    size_t codificar(const char* texto, size_t n, char* destino);
+
+    /**
+     * @brief Reescribe una línea de un flujo PRT-7 existente sobre el flujo mínimo
+     * @details Las tramas M del flujo original solo actualizan el desplazamiento de entrada; cada
+     * trama L se decodifica y se vuelve a codificar con el desplazamiento del flujo de salida.
+     * Las líneas vacías o mal formadas se descartan, igual que en el decodificador.
+     * @param linea Línea sin salto final (ej. "L,A" o "M,-3")
+     * @param destino Búfer con al menos capacidadNecesaria(1) bytes
+     * @return Bytes escritos en destino
+     */
+    size_t comprimirLinea(const char* linea, char* destino);
+
+    /**
+     * @brief Emite la trama M más corta que deja el rotor en el desplazamiento indicado
+     * @param desplazamientoFinal Desplazamiento deseado
+     * @param destino Búfer con al menos 16 bytes
+     * @return Bytes escritos en destino (0 si el rotor ya está en ese desplazamiento)
+     */
+    size_t rotarA(int desplazamientoFinal, char* destino);
+
+    /**
+     * @brief Obtiene el desplazamiento actual del rotor del decodificador
+     * @return Desplazamiento en el rango 0..25
+     */
+    int getDesplazamiento() const { return desplazamiento; }
+
+    /**
+     * @brief Obtiene el desplazamiento al que llegó el flujo que se está comprimiendo
+     * @return Desplazamiento en el rango 0..25
+     */
+    int getDesplazamientoEntrada() const { return desplazamientoEntrada; }
+
+    /**
+     * @brief Obtiene la cantidad de caracteres que no se pudieron codificar
+     * @return Caracteres omitidos desde la creación del codificador
+     */
+    size_t getOmitidos() const { return omitidos; }
+};
+
+#endif // CODIFICADORPRT7_H
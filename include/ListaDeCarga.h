@@ -29,9 +29,10 @@ private:
     
     Nodo* cabeza; ///< Primer nodo de la lista
     Nodo* cola;   ///< Último nodo de la lista
+    int longitud; ///< Cantidad de caracteres almacenados
     
 public:
-    ListaDeCarga() : cabeza(nullptr), cola(nullptr) {}
+    ListaDeCarga() : cabeza(nullptr), cola(nullptr), longitud(0) {}
 
     void insertarAlFinal(char c) {
         Nodo* nuevo = new Nodo(c);
@@ -46,6 +47,26 @@ public:
             nuevo->anterior = cola;
             cola = nuevo;
         }
+        longitud++;
+    }
+
+    /**
+     * @brief Obtiene la cantidad de caracteres almacenados
+     * @return Número de nodos de la lista
+     */
+    int getLongitud() const { return longitud; }
+
+    /**
+     * @brief Copia el mensaje a un búfer de caracteres terminado en '\0'
+     * @param destino Búfer con capacidad para al menos getLongitud() + 1 caracteres
+     */
+    void copiarMensaje(char* destino) const {
+        Nodo* actual = cabeza;
+        while (actual) {
+            *destino++ = actual->dato;
+            actual = actual->siguiente;
+        }
+        *destino = '\0';
     }
 
     void imprimirMensaje() const {
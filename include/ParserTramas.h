@@ -0,0 +1,20 @@
+/**
+ * @file ParserTramas.h
+ * @brief Interpretación de las líneas de texto del protocolo PRT-7
+ * @ingroup data_management
+ */
+#ifndef PARSERTRAMAS_H
+#define PARSERTRAMAS_H
+
+#include "TramaBase.h"
+
+/**
+ * @brief Parsea una línea del serial y crea la trama correspondiente
+ * @param linea Cadena recibida (ej. "L,A", "L,Space" o "M,5")
+ * @param verboso Si es true, imprime los avisos y errores de parseo en consola
+ * @return Puntero a TramaBase (TramaLoad o TramaMap) o nullptr si hay error.
+ * El llamador es responsable de liberar la trama con delete.
+ */
+TramaBase* parsearTrama(const char* linea, bool verboso = true);
+
+#endif // PARSERTRAMAS_H
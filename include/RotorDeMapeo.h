@@ -56,9 +56,25 @@ public:
         }
     }
 
+    /**
+     * @brief Reduce una rotación al giro equivalente más corto
+     * @param n Rotación en posiciones (positiva o negativa)
+     * @return Rotación equivalente en el rango -12..13
+     */
+    static int giroMinimo(int n) {
+        n %= 26;
+        if (n > 13) n -= 26;
+        if (n < -12) n += 26;
+        return n;
+    }
+
     void rotar(int n) {
         if (!cabeza) return;
         
+        // Reducir al giro más corto para no recorrer vueltas completas
+        // del disco con valores grandes de N
+        n = giroMinimo(n);
+        
         if (n > 0) {
             // Rotar hacia adelante
             for (int i = 0; i < n; i++) {
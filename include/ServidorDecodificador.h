@@ -0,0 +1,134 @@
+/**
+ * @file ServidorDecodificador.h
+ * @brief Servicio de decodificación PRT-7 sobre un socket de dominio Unix.
+ * @ingroup hardware
+ */
+#ifndef SERVIDORDECODIFICADOR_H
+#define SERVIDORDECODIFICADOR_H
+
+#include <pthread.h>
+#include <csignal>
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+
+/**
+ * @class ServidorDecodificador
+ * @brief Decodificador de larga duración que atiende muchas sesiones concurrentes.
+ * @details Cada conexión al socket es una sesión con su propio RotorDeMapeo y ListaDeCarga.
+ * El cliente envía tramas PRT-7 terminadas en salto de línea ("L,A", "M,-2", "FIN") y recibe:
+ * - "D,X" por cada trama de carga, con X el carácter decodificado ("D,Space" para el espacio).
+ * - "E,<linea>" por cada trama mal formada.
+ * - "MENSAJE,<texto>" al recibir "FIN" o al cerrar el cliente su lado de escritura; después
+ *   el servidor cierra la sesión.
+ * - "E,MENSAJE_DEMASIADO_LARGO" si el mensaje supera el máximo por sesión; después el servidor
+ *   cierra la sesión sin enviar el mensaje.
+ *
+ * Las sesiones que pasan demasiado tiempo sin enviar ni recibir datos se desconectan.
+ *
+ * Un único hilo espera eventos con epoll y reparte las sesiones listas a un grupo fijo de
+ * hilos trabajadores. Cada sesión se registra con EPOLLONESHOT, de modo que solo un
+ * trabajador la atiende a la vez y no necesita bloqueos propios.
+ */
+class ServidorDecodificador {
+private:
+    /**
+     * @struct Sesion
+     * @brief Estado de una conexión de cliente
+     */
+    struct Sesion {
+        int fd;                     ///< Descriptor del socket del cliente
+        RotorDeMapeo rotor;         ///< Disco de cifrado propio de la sesión
+        ListaDeCarga carga;         ///< Mensaje decodificado de la sesión
+        char entrada[256];          ///< Línea parcial pendiente de completar
+        int lenEntrada;             ///< Caracteres acumulados en entrada
+        char* salida;               ///< Respuestas pendientes de enviar
+        int lenSalida;              ///< Bytes válidos en salida
+        int capSalida;              ///< Capacidad reservada de salida
+        int enviados;               ///< Bytes de salida ya enviados al cliente
+        bool finalizada;            ///< Se envió el mensaje final; cerrar al vaciar la salida
+        bool descartando;           ///< Escritura cerrada; se descarta la entrada hasta que el cliente cierre
+        long ultimaActividad;       ///< Segundo (monótono) del último dato leído o enviado
+        Sesion* anterior;           ///< Sesión anterior en el registro
+        Sesion* siguiente;          ///< Sesión siguiente en el registro
+        Sesion* siguienteEnCola;    ///< Siguiente sesión en la cola de trabajo
+
+        Sesion(int descriptor, long ahora)
+            : fd(descriptor), lenEntrada(0), salida(nullptr), lenSalida(0), capSalida(0),
+              enviados(0), finalizada(false), descartando(false), ultimaActividad(ahora),
+              anterior(nullptr), siguiente(nullptr), siguienteEnCola(nullptr) {}
+
+        ~Sesion() { delete[] salida; }
+    };
+
+    const char* ruta;               ///< Ruta del socket de dominio Unix
+    int fdEscucha;                  ///< Socket que acepta conexiones
+    int fdEpoll;                    ///< Instancia de epoll
+    int tuberia[2];                 ///< Tubería para despertar al hilo de eventos al detener
+    int fdReserva;                  ///< Descriptor reservado para rechazar conexiones sin descriptores libres
+    bool socketCreado;              ///< Esta instancia creó el archivo del socket y debe eliminarlo
+    bool escuchando;                ///< Indicador de que el socket quedó listo
+
+    volatile sig_atomic_t detenido; ///< Solicitud de parada (segura desde un manejador de señal)
+
+    pthread_t* hilos;               ///< Hilos trabajadores
+    int numHilos;                   ///< Cantidad de hilos trabajadores
+    bool hilosDetenidos;            ///< Indica a los trabajadores que deben terminar
+    pthread_mutex_t mutexCola;      ///< Protege la cola de trabajo
+    pthread_cond_t condCola;        ///< Señala sesiones nuevas en la cola
+    Sesion* cabezaCola;             ///< Primera sesión pendiente de atender
+    Sesion* finCola;                ///< Última sesión pendiente de atender
+
+    pthread_mutex_t mutexRegistro;  ///< Protege el registro de sesiones y Sesion::ultimaActividad
+    Sesion* registro;               ///< Lista doblemente enlazada de sesiones abiertas
+    int sesionesActivas;            ///< Cantidad de sesiones en el registro
+
+    static void* rutinaTrabajador(void* arg);
+    void trabajar();
+    void encolar(Sesion* s);
+    void aceptarConexiones();
+    void atenderSesion(Sesion* s);
+    bool leerSesion(Sesion* s);
+    bool descartarEntrada(Sesion* s);
+    void procesarLinea(Sesion* s);
+    void finalizarSesion(Sesion* s);
+    bool vaciarSalida(Sesion* s);
+    void agregarSalida(Sesion* s, const char* datos, int n);
+    void registrar(Sesion* s);
+    void marcarActividad(Sesion* s);
+    void revisarInactivas();
+    void cerrarSesion(Sesion* s);
+
+public:
+    /**
+     * @brief Crea el socket de escucha y arranca el grupo de hilos trabajadores.
+     * @param rutaSocket Ruta del socket de dominio Unix. Solo se reemplaza si es un socket que
+     * ya no acepta conexiones; un archivo común o un servidor activo en esa ruta es un error.
+     * @param hilosTrabajadores Cantidad fija de hilos que procesan las sesiones.
+     */
+    ServidorDecodificador(const char* rutaSocket, int hilosTrabajadores);
+
+    /**
+     * @brief Comprueba si el socket quedó escuchando.
+     * @return true si el servidor puede ejecutarse, false en caso contrario.
+     */
+    bool estaEscuchando() const;
+
+    /**
+     * @brief Atiende conexiones y eventos hasta que se llame a detener().
+     */
+    void ejecutar();
+
+    /**
+     * @brief Solicita la parada del servidor.
+     * @details Solo usa operaciones seguras en señales, por lo que puede llamarse desde un
+     * manejador de SIGINT/SIGTERM.
+     */
+    void detener();
+
+    /**
+     * @brief Detiene los trabajadores, cierra todas las sesiones y elimina el socket.
+     */
+    ~ServidorDecodificador();
+};
+
+#endif // SERVIDORDECODIFICADOR_H
@@ -23,6 +23,14 @@ public:
      */
     virtual void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) = 0;
     
+    /**
+     * @brief Aplica la trama sobre las estructuras sin imprimir mensajes de depuración
+     * @param carga Puntero a la lista de carga donde se almacena el mensaje
+     * @param rotor Puntero al rotor de mapeo que realiza la decodificación
+     * @return Carácter decodificado, o '\0' si la trama no produce ningún carácter
+     */
+    virtual char aplicar(ListaDeCarga* carga, RotorDeMapeo* rotor) = 0;
+    
     /**
      * @brief Destructor virtual para asegurar la limpieza polimórfica
      */
@@ -51,9 +59,7 @@ public:
      */
     void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) override {
         // Decodificar el carácter usando el rotor
-        char decodificado = NULL;
-        if(carga) {decodificado = rotor->getMapeo(caracter);}
-        carga->insertarAlFinal(decodificado);
+        char decodificado = aplicar(carga, rotor);
         
         // Mensaje de depuración
         if(caracter==' '){
@@ -68,6 +74,18 @@ public:
         carga->imprimirMensajeDetallado();
     }
     
+    /**
+     * @brief Decodifica el carácter y lo agrega a la lista sin imprimir nada
+     * @param carga Lista donde se agrega el carácter decodificado
+     * @param rotor Rotor utilizado para decodificar
+     * @return El carácter decodificado
+     */
+    char aplicar(ListaDeCarga* carga, RotorDeMapeo* rotor) override {
+        char decodificado = rotor->getMapeo(caracter);
+        carga->insertarAlFinal(decodificado);
+        return decodificado;
+    }
+    
     /**
      * @brief Obtiene el carácter almacenado
      * @return El carácter de la trama
@@ -105,6 +123,18 @@ public:
         if (rotacion > 0) std::cout << "+";
         std::cout << rotacion << ".\n";
     }
+    
+    /**
+     * @brief Rota el disco de cifrado sin imprimir nada
+     * @param carga No se utiliza en esta trama
+     * @param rotor Rotor que será rotado
+     * @return Siempre '\0', una trama de mapeo no produce caracteres
+     */
+    char aplicar(ListaDeCarga* carga, RotorDeMapeo* rotor) override {
+        (void)carga;
+        rotor->rotar(rotacion);
+        return '\0';
+    }
 
     
     /**
@@ -0,0 +1,95 @@
+/**
+ * @file CodificadorPRT7.cpp
+ * @brief Implementación de la clase CodificadorPRT7.
+ * @details Genera el flujo de tramas más corto para un texto, o para el mensaje de un flujo
+ * PRT-7 existente, según la semántica de RotorDeMapeo.
+ */
+#include "CodificadorPRT7.h"
+#include "ParserTramas.h"
+#include "RotorDeMapeo.h"
+#include <cstdio>
+#include <cstring>
+
+/**
+ * @brief Constructor de la clase CodificadorPRT7.
+ * @param desplazamientoInicial Desplazamiento del rotor del decodificador al empezar (se normaliza a 0..25).
+ */
+CodificadorPRT7::CodificadorPRT7(int desplazamientoInicial)
+    : desplazamiento(0), desplazamientoEntrada(0), omitidos(0) {
+    desplazamiento = (RotorDeMapeo::giroMinimo(desplazamientoInicial) + 26) % 26;
+    desplazamientoEntrada = desplazamiento;
+    construirTabla();
+}
+
+char CodificadorPRT7::mapear(char entrada, int desplazamiento) {
+    if (entrada >= 'A' && entrada <= 'Z') {
+        return 'A' + (entrada - 'A' + desplazamiento) % 26;
+    }
+    return entrada;
+}
+
+/**
+ * @brief Llena la tabla con el carácter que hay que enviar para obtener cada carácter de texto.
+ * @details Es la inversa de mapear(): las letras se desplazan hacia atrás y el resto se envía tal
+ * cual. Los caracteres que no caben en una trama quedan en '\0'.
+ */
+void CodificadorPRT7::construirTabla() {
+    for (int i = 0; i < 256; i++) {
+        tabla[i] = (char)i;
+    }
+    for (int i = 0; i < 26; i++) {
+        tabla['A' + i] = 'A' + (i - desplazamiento + 26) % 26;
+    }
+    tabla[(unsigned char)'\n'] = '\0';
+    tabla[(unsigned char)'\r'] = '\0';
+}
+
+size_t CodificadorPRT7::codificar(const char* texto, size_t n, char* destino) {
+    char* p = destino;
+    for (size_t i = 0; i < n; i++) {
+        char c = tabla[(unsigned char)texto[i]];
+        if (c == '\0') {
+            omitidos++;
+        } else if (c == ' ') {
+            std::memcpy(p, "L,Space\n", 8);
+            p += 8;
+        } else {
+            p[0] = 'L';
+            p[1] = ',';
+            p[2] = c;
+            p[3] = '\n';
+            p += 4;
+        }
+    }
+    return p - destino;
+}
+
+size_t CodificadorPRT7::comprimirLinea(const char* linea, char* destino) {
+    TramaBase* trama = parsearTrama(linea, false);
+    if (!trama) {
+        return 0;
+    }
+
+    size_t escritos = 0;
+    TramaMap* mapa = dynamic_cast<TramaMap*>(trama);
+    if (mapa) {
+        int giro = RotorDeMapeo::giroMinimo(mapa->getRotacion());
+        desplazamientoEntrada = (desplazamientoEntrada + giro + 26) % 26;
+    } else {
+        TramaLoad* load = static_cast<TramaLoad*>(trama);
+        char decodificado = mapear(load->getCaracter(), desplazamientoEntrada);
+        escritos = codificar(&decodificado, 1, destino);
+    }
+    delete trama;
+    return escritos;
+}
+
+size_t CodificadorPRT7::rotarA(int desplazamientoFinal, char* destino) {
+    int giro = RotorDeMapeo::giroMinimo(desplazamientoFinal - desplazamiento);
+    if (giro == 0) {
+        return 0;
+    }
+    desplazamiento = (desplazamiento + giro + 26) % 26;
+    construirTabla();
+    return std::sprintf(destino, "M,%d\n", giro);
+}
@@ -0,0 +1,43 @@
+/**
+ * @file ParserTramas.cpp
+ * @brief Implementación del parseo de tramas del protocolo PRT-7.
+ * @details Compartido por el decodificador serial y el servicio de decodificación por socket.
+ */
+#include "ParserTramas.h"
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+
+TramaBase* parsearTrama(const char* linea, bool verboso) {
+    if (!linea || linea[0] == '\0') {
+        return nullptr;
+    }
+    
+    // Verificar formato mínimo: "X,Y"
+    if (std::strlen(linea) < 3 || linea[1] != ',') {
+        if (verboso) std::cerr << "[ERROR] Trama mal formada: " << linea << std::endl;
+        return nullptr;
+    }
+    
+    char tipo = linea[0];
+    
+    if (tipo == 'L') {
+        // Trama de carga: L,X donde X es un carácter
+        const char* dato = &linea[2];
+        if (std::strcmp(dato, "Space") == 0) {
+            if (verboso) std::cout << "[INFO] Trama especial L,Space recibida.\n";
+            return new TramaLoad(' '); // Crea una TramaLoad con el carácter espacio
+        }
+        char caracter = linea[2];
+        return new TramaLoad(caracter);
+    } 
+    else if (tipo == 'M') {
+        // Trama de mapeo: M,N donde N es un entero
+        int rotacion = std::atoi(&linea[2]);
+        return new TramaMap(rotacion);
+    } 
+    else {
+        if (verboso) std::cerr << "[ERROR] Tipo de trama desconocido: " << tipo << std::endl;
+        return nullptr;
+    }
+}
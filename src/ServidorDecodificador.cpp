@@ -0,0 +1,594 @@
+/**
+ * @file ServidorDecodificador.cpp
+ * @brief Implementación de la clase ServidorDecodificador.
+ * @details Servicio de decodificación PRT-7 sobre un socket de dominio Unix, con epoll para
+ * los eventos de E/S y un grupo fijo de hilos para procesar las sesiones.
+ */
+#include "ServidorDecodificador.h"
+#include "ParserTramas.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <ctime>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+
+namespace {
+const int MAX_EVENTOS = 128;           ///< Eventos recogidos por cada llamada a epoll_wait
+const int TAM_LECTURA = 4096;          ///< Bytes leídos del socket por llamada a read
+const int LECTURAS_POR_TURNO = 16;     ///< Lecturas máximas antes de ceder el trabajador a otra sesión
+const int LIMITE_SALIDA = 64 * 1024;   ///< Salida pendiente a partir de la cual se deja de leer al cliente
+const int MAX_MENSAJE = 64 * 1024;     ///< Caracteres decodificados máximos por sesión
+const long TIEMPO_INACTIVO = 30;       ///< Segundos sin actividad tras los que se desconecta una sesión
+const int INTERVALO_REVISION = 1000;   ///< Milisegundos entre revisiones de sesiones inactivas
+
+/**
+ * @brief Segundos transcurridos en un reloj monótono (no afectado por cambios de hora)
+ * @return Segundos actuales
+ */
+long segundosActuales() {
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec;
+}
+}
+
+/**
+ * @brief Constructor de la clase ServidorDecodificador.
+ * @details Crea el socket de escucha, la instancia de epoll y la tubería de parada, y arranca los
+ * hilos trabajadores. Ante cualquier error informa por consola y deja estaEscuchando() en false.
+ * @param rutaSocket Ruta del socket de dominio Unix.
+ * @param hilosTrabajadores Cantidad de hilos trabajadores (mínimo 1).
+ */
+ServidorDecodificador::ServidorDecodificador(const char* rutaSocket, int hilosTrabajadores)
+    : ruta(rutaSocket), fdEscucha(-1), fdEpoll(-1), fdReserva(-1), socketCreado(false), escuchando(false),
+      detenido(0), hilos(nullptr), numHilos(0), hilosDetenidos(false), cabezaCola(nullptr), finCola(nullptr),
+      registro(nullptr), sesionesActivas(0) {
+    tuberia[0] = -1;
+    tuberia[1] = -1;
+    pthread_mutex_init(&mutexCola, nullptr);
+    pthread_cond_init(&condCola, nullptr);
+    pthread_mutex_init(&mutexRegistro, nullptr);
+
+    sockaddr_un direccion;
+    std::memset(&direccion, 0, sizeof(direccion));
+    direccion.sun_family = AF_UNIX;
+    if (std::strlen(ruta) >= sizeof(direccion.sun_path)) {
+        std::cerr << "[ERROR] Ruta de socket demasiado larga: " << ruta << std::endl;
+        return;
+    }
+    std::strcpy(direccion.sun_path, ruta);
+
+    // Solo se reemplaza un socket abandonado: nunca un archivo común ni el de otro servidor activo
+    struct stat info;
+    if (lstat(ruta, &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            std::cerr << "[ERROR] " << ruta << " existe y no es un socket" << std::endl;
+            return;
+        }
+        int prueba = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (prueba < 0) {
+            std::cerr << "[ERROR] No se pudo crear el socket (Error: " << errno << ")" << std::endl;
+            return;
+        }
+        int resultado = connect(prueba, (sockaddr*)&direccion, sizeof(direccion));
+        int error = errno;
+        close(prueba);
+        if (resultado == 0) {
+            std::cerr << "[ERROR] Ya hay un servidor escuchando en " << ruta << std::endl;
+            return;
+        }
+        if (error != ECONNREFUSED) {
+            std::cerr << "[ERROR] No se pudo comprobar el socket " << ruta << " (Error: " << error << ")" << std::endl;
+            return;
+        }
+        // Socket de una ejecución anterior que ya no acepta conexiones
+        unlink(ruta);
+    }
+
+    fdEscucha = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fdEscucha < 0) {
+        std::cerr << "[ERROR] No se pudo crear el socket (Error: " << errno << ")" << std::endl;
+        return;
+    }
+
+    if (bind(fdEscucha, (sockaddr*)&direccion, sizeof(direccion)) != 0) {
+        std::cerr << "[ERROR] No se pudo escuchar en " << ruta << " (Error: " << errno << ")" << std::endl;
+        return;
+    }
+    socketCreado = true;
+    if (listen(fdEscucha, SOMAXCONN) != 0) {
+        std::cerr << "[ERROR] No se pudo escuchar en " << ruta << " (Error: " << errno << ")" << std::endl;
+        return;
+    }
+
+    fdEpoll = epoll_create1(EPOLL_CLOEXEC);
+    if (fdEpoll < 0 || pipe2(tuberia, O_NONBLOCK | O_CLOEXEC) != 0) {
+        std::cerr << "[ERROR] No se pudo inicializar epoll (Error: " << errno << ")" << std::endl;
+        return;
+    }
+
+    // El socket de escucha se identifica con ptr nulo y la tubería con el propio servidor;
+    // cualquier otro ptr es una Sesion
+    epoll_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = nullptr;
+    epoll_ctl(fdEpoll, EPOLL_CTL_ADD, fdEscucha, &ev);
+    ev.data.ptr = this;
+    epoll_ctl(fdEpoll, EPOLL_CTL_ADD, tuberia[0], &ev);
+
+    fdReserva = open("/dev/null", O_RDONLY | O_CLOEXEC);
+
+    if (hilosTrabajadores < 1) hilosTrabajadores = 1;
+    hilos = new pthread_t[hilosTrabajadores];
+    for (int i = 0; i < hilosTrabajadores; i++) {
+        if (pthread_create(&hilos[i], nullptr, rutinaTrabajador, this) != 0) {
+            std::cerr << "[ERROR] No se pudo crear el hilo trabajador " << i << std::endl;
+            break;
+        }
+        numHilos++;
+    }
+    if (numHilos == 0) {
+        return;
+    }
+
+    escuchando = true;
+    std::cout << "[OK] Servidor escuchando en " << ruta << " con " << numHilos << " hilos" << std::endl;
+}
+
+/**
+ * @brief Verifica si el servidor quedó listo para atender conexiones.
+ * @return true si el socket, epoll y los trabajadores se inicializaron correctamente.
+ */
+bool ServidorDecodificador::estaEscuchando() const {
+    return escuchando;
+}
+
+/**
+ * @brief Bucle del hilo de eventos.
+ * @details Acepta conexiones nuevas y entrega a la cola de trabajo las sesiones con datos
+ * disponibles o con espacio para escribir, hasta que se solicite la parada. Una vez por
+ * segundo desconecta las sesiones inactivas.
+ */
+void ServidorDecodificador::ejecutar() {
+    if (!escuchando) return;
+
+    epoll_event eventos[MAX_EVENTOS];
+    long ultimaRevision = segundosActuales();
+    while (!detenido) {
+        int n = epoll_wait(fdEpoll, eventos, MAX_EVENTOS, INTERVALO_REVISION);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "[ERROR] Error en epoll_wait (Error: " << errno << ")" << std::endl;
+            break;
+        }
+
+        for (int i = 0; i < n; i++) {
+            void* origen = eventos[i].data.ptr;
+            if (origen == nullptr) {
+                aceptarConexiones();
+            } else if (origen == this) {
+                detenido = 1;
+            } else {
+                encolar(static_cast<Sesion*>(origen));
+            }
+        }
+
+        long ahora = segundosActuales();
+        if (ahora != ultimaRevision) {
+            ultimaRevision = ahora;
+            revisarInactivas();
+        }
+    }
+}
+
+/**
+ * @brief Solicita la parada despertando al hilo de eventos a través de la tubería.
+ */
+void ServidorDecodificador::detener() {
+    detenido = 1;
+    if (tuberia[1] >= 0) {
+        char c = 0;
+        ssize_t r = write(tuberia[1], &c, 1);
+        (void)r;
+    }
+}
+
+/**
+ * @brief Destructor de la clase ServidorDecodificador.
+ * @details Espera a que terminen los trabajadores, libera todas las sesiones abiertas y
+ * cierra los descriptores. El archivo del socket solo se elimina si esta instancia lo creó.
+ */
+ServidorDecodificador::~ServidorDecodificador() {
+    pthread_mutex_lock(&mutexCola);
+    hilosDetenidos = true;
+    pthread_cond_broadcast(&condCola);
+    pthread_mutex_unlock(&mutexCola);
+    for (int i = 0; i < numHilos; i++) {
+        pthread_join(hilos[i], nullptr);
+    }
+    delete[] hilos;
+
+    // Ya no quedan trabajadores: liberar las sesiones que siguen abiertas
+    int cerradas = sesionesActivas;
+    while (registro) {
+        cerrarSesion(registro);
+    }
+    if (escuchando) {
+        std::cout << "[OK] Servidor detenido, " << cerradas << " sesiones cerradas" << std::endl;
+    }
+
+    if (fdReserva >= 0) close(fdReserva);
+    if (tuberia[0] >= 0) close(tuberia[0]);
+    if (tuberia[1] >= 0) close(tuberia[1]);
+    if (fdEpoll >= 0) close(fdEpoll);
+    if (fdEscucha >= 0) close(fdEscucha);
+    if (socketCreado) unlink(ruta);
+    pthread_mutex_destroy(&mutexRegistro);
+    pthread_cond_destroy(&condCola);
+    pthread_mutex_destroy(&mutexCola);
+}
+
+void* ServidorDecodificador::rutinaTrabajador(void* arg) {
+    static_cast<ServidorDecodificador*>(arg)->trabajar();
+    return nullptr;
+}
+
+/**
+ * @brief Bucle de un hilo trabajador: toma sesiones de la cola y las atiende.
+ */
+void ServidorDecodificador::trabajar() {
+    while (true) {
+        pthread_mutex_lock(&mutexCola);
+        while (!cabezaCola && !hilosDetenidos) {
+            pthread_cond_wait(&condCola, &mutexCola);
+        }
+        if (hilosDetenidos) {
+            pthread_mutex_unlock(&mutexCola);
+            return;
+        }
+        Sesion* s = cabezaCola;
+        cabezaCola = s->siguienteEnCola;
+        if (!cabezaCola) finCola = nullptr;
+        s->siguienteEnCola = nullptr;
+        pthread_mutex_unlock(&mutexCola);
+
+        atenderSesion(s);
+    }
+}
+
+/**
+ * @brief Agrega una sesión lista al final de la cola de trabajo.
+ * @param s Sesión que recibió un evento; EPOLLONESHOT garantiza que no está ya en la cola.
+ */
+void ServidorDecodificador::encolar(Sesion* s) {
+    pthread_mutex_lock(&mutexCola);
+    if (finCola) {
+        finCola->siguienteEnCola = s;
+    } else {
+        cabezaCola = s;
+    }
+    finCola = s;
+    pthread_cond_signal(&condCola);
+    pthread_mutex_unlock(&mutexCola);
+}
+
+/**
+ * @brief Acepta todas las conexiones pendientes y registra una sesión por cada una.
+ */
+void ServidorDecodificador::aceptarConexiones() {
+    while (true) {
+        int fd = accept4(fdEscucha, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if ((errno == EMFILE || errno == ENFILE) && fdReserva >= 0) {
+                // Sin descriptores libres: liberar el de reserva para aceptar y rechazar la
+                // conexión; si no, el socket de escucha seguiría listo y el bucle giraría en vacío
+                close(fdReserva);
+                fd = accept(fdEscucha, nullptr, nullptr);
+                if (fd >= 0) close(fd);
+                fdReserva = open("/dev/null", O_RDONLY | O_CLOEXEC);
+                std::cerr << "[ERROR] Sin descriptores libres, conexión rechazada" << std::endl;
+            }
+            return;
+        }
+
+        Sesion* s = new Sesion(fd, segundosActuales());
+        registrar(s);
+
+        epoll_event ev;
+        std::memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN | EPOLLONESHOT;
+        ev.data.ptr = s;
+        if (epoll_ctl(fdEpoll, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            cerrarSesion(s);
+        }
+    }
+}
+
+/**
+ * @brief Procesa una sesión lista y la vuelve a armar en epoll o la cierra.
+ * @param s Sesión a atender; solo este trabajador la usa hasta que se rearme.
+ */
+void ServidorDecodificador::atenderSesion(Sesion* s) {
+    bool abierta = true;
+
+    // Si el cliente no está leyendo las respuestas, dejar de leer sus tramas
+    if (s->descartando) {
+        abierta = descartarEntrada(s);
+    } else if (!s->finalizada && s->lenSalida - s->enviados < LIMITE_SALIDA) {
+        abierta = leerSesion(s);
+    }
+    if (abierta && !s->descartando) {
+        abierta = vaciarSalida(s);
+    }
+
+    bool pendiente = s->enviados < s->lenSalida;
+    if (abierta && s->finalizada && !pendiente && !s->descartando) {
+        // Cerrar con tramas sin leer hace que el cliente reciba un reinicio y pierda las
+        // respuestas: en ese caso se cierra solo la escritura y se descarta la entrada
+        int sinLeer = 0;
+        if (ioctl(s->fd, FIONREAD, &sinLeer) == 0 && sinLeer > 0) {
+            shutdown(s->fd, SHUT_WR);
+            s->descartando = true;
+        } else {
+            abierta = false;
+        }
+    }
+    if (!abierta) {
+        cerrarSesion(s);
+        return;
+    }
+
+    epoll_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLONESHOT;
+    if (s->descartando || (!s->finalizada && s->lenSalida - s->enviados < LIMITE_SALIDA)) ev.events |= EPOLLIN;
+    if (pendiente) ev.events |= EPOLLOUT;
+    ev.data.ptr = s;
+    if (epoll_ctl(fdEpoll, EPOLL_CTL_MOD, s->fd, &ev) != 0) {
+        cerrarSesion(s);
+    }
+}
+
+/**
+ * @brief Lee los datos disponibles del cliente y procesa cada línea completa.
+ * @details Cada '\n' termina una línea, los '\r' se descartan y una línea de 255 caracteres se
+ * procesa aunque no haya llegado el salto, igual que ArduinoSerial::leerLinea().
+ * @param s Sesión a leer.
+ * @return false si ocurrió un error de lectura y la sesión debe cerrarse.
+ */
+bool ServidorDecodificador::leerSesion(Sesion* s) {
+    char buf[TAM_LECTURA];
+
+    for (int lecturas = 0; lecturas < LECTURAS_POR_TURNO && !s->finalizada; lecturas++) {
+        ssize_t n = read(s->fd, buf, sizeof(buf));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return true;
+            return false;
+        }
+        if (n == 0) {
+            // El cliente cerró su lado de escritura: equivale a "FIN"
+            finalizarSesion(s);
+            return true;
+        }
+        marcarActividad(s);
+
+        for (ssize_t i = 0; i < n && !s->finalizada; i++) {
+            char c = buf[i];
+            if (c == '\n') {
+                s->entrada[s->lenEntrada] = '\0';
+                procesarLinea(s);
+            } else if (c != '\r') {
+                s->entrada[s->lenEntrada++] = c;
+                if (s->lenEntrada == 255) {
+                    s->entrada[255] = '\0';
+                    procesarLinea(s);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Lee y descarta lo que envíe el cliente después de finalizar la sesión.
+ * @param s Sesión con la escritura ya cerrada.
+ * @return false cuando el cliente cerró la conexión o hubo un error, y la sesión debe cerrarse.
+ */
+bool ServidorDecodificador::descartarEntrada(Sesion* s) {
+    char buf[TAM_LECTURA];
+
+    for (int lecturas = 0; lecturas < LECTURAS_POR_TURNO; lecturas++) {
+        ssize_t n = read(s->fd, buf, sizeof(buf));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        if (n == 0) {
+            return false;
+        }
+        marcarActividad(s);
+    }
+    return true;
+}
+
+/**
+ * @brief Ejecuta la línea acumulada en la sesión y encola la respuesta correspondiente.
+ * @param s Sesión cuya línea de entrada está completa y terminada en '\0'.
+ */
+void ServidorDecodificador::procesarLinea(Sesion* s) {
+    int len = s->lenEntrada;
+    s->lenEntrada = 0;
+    if (len == 0) {
+        return;
+    }
+
+    if (std::strcmp(s->entrada, "FIN") == 0) {
+        finalizarSesion(s);
+        return;
+    }
+
+    TramaBase* trama = parsearTrama(s->entrada, false);
+    if (!trama) {
+        agregarSalida(s, "E,", 2);
+        agregarSalida(s, s->entrada, len);
+        agregarSalida(s, "\n", 1);
+        return;
+    }
+
+    char decodificado = trama->aplicar(&s->carga, &s->rotor);
+    delete trama;
+
+    // Limitar la memoria de un cliente que nunca envía "FIN"
+    if (s->carga.getLongitud() > MAX_MENSAJE) {
+        agregarSalida(s, "E,MENSAJE_DEMASIADO_LARGO\n", 26);
+        s->finalizada = true;
+        return;
+    }
+
+    if (decodificado == ' ') {
+        agregarSalida(s, "D,Space\n", 8);
+    } else if (decodificado != '\0') {
+        char respuesta[4] = { 'D', ',', decodificado, '\n' };
+        agregarSalida(s, respuesta, 4);
+    }
+}
+
+/**
+ * @brief Encola el mensaje ensamblado de la sesión y la marca para cierre.
+ * @param s Sesión que recibió "FIN" o fin de flujo.
+ */
+void ServidorDecodificador::finalizarSesion(Sesion* s) {
+    if (s->finalizada) return;
+
+    int longitud = s->carga.getLongitud();
+    char* mensaje = new char[longitud + 1];
+    s->carga.copiarMensaje(mensaje);
+
+    agregarSalida(s, "MENSAJE,", 8);
+    agregarSalida(s, mensaje, longitud);
+    agregarSalida(s, "\n", 1);
+    delete[] mensaje;
+
+    s->finalizada = true;
+}
+
+/**
+ * @brief Envía al cliente toda la salida pendiente que admita el socket.
+ * @param s Sesión a vaciar.
+ * @return false si el cliente ya no puede recibir datos y la sesión debe cerrarse.
+ */
+bool ServidorDecodificador::vaciarSalida(Sesion* s) {
+    while (s->enviados < s->lenSalida) {
+        ssize_t n = send(s->fd, s->salida + s->enviados, s->lenSalida - s->enviados, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return true;
+            return false;
+        }
+        s->enviados += n;
+        marcarActividad(s);
+    }
+    s->lenSalida = 0;
+    s->enviados = 0;
+    return true;
+}
+
+/**
+ * @brief Agrega bytes al búfer de salida de la sesión, ampliándolo si hace falta.
+ * @param s Sesión destino.
+ * @param datos Bytes a agregar.
+ * @param n Cantidad de bytes.
+ */
+void ServidorDecodificador::agregarSalida(Sesion* s, const char* datos, int n) {
+    if (s->lenSalida + n > s->capSalida) {
+        // Descartar lo ya enviado antes de decidir si hace falta más memoria
+        if (s->enviados > 0) {
+            std::memmove(s->salida, s->salida + s->enviados, s->lenSalida - s->enviados);
+            s->lenSalida -= s->enviados;
+            s->enviados = 0;
+        }
+        if (s->lenSalida + n > s->capSalida) {
+            int capacidad = s->capSalida ? s->capSalida : 256;
+            while (capacidad < s->lenSalida + n) capacidad *= 2;
+            char* nueva = new char[capacidad];
+            if (s->lenSalida > 0) std::memcpy(nueva, s->salida, s->lenSalida);
+            delete[] s->salida;
+            s->salida = nueva;
+            s->capSalida = capacidad;
+        }
+    }
+    std::memcpy(s->salida + s->lenSalida, datos, n);
+    s->lenSalida += n;
+}
+
+/**
+ * @brief Inserta la sesión al inicio del registro de sesiones abiertas.
+ * @param s Sesión recién aceptada.
+ */
+void ServidorDecodificador::registrar(Sesion* s) {
+    pthread_mutex_lock(&mutexRegistro);
+    s->siguiente = registro;
+    if (registro) registro->anterior = s;
+    registro = s;
+    sesionesActivas++;
+    pthread_mutex_unlock(&mutexRegistro);
+}
+
+/**
+ * @brief Registra que la sesión leyó o envió datos.
+ * @details Solo el trabajador que atiende la sesión escribe el campo, y lo hace con el mutex del
+ * registro para que revisarInactivas() lo lea sin carreras; basta con escribir una vez por segundo.
+ * @param s Sesión atendida por el trabajador actual.
+ */
+void ServidorDecodificador::marcarActividad(Sesion* s) {
+    long ahora = segundosActuales();
+    if (ahora == s->ultimaActividad) return;
+    pthread_mutex_lock(&mutexRegistro);
+    s->ultimaActividad = ahora;
+    pthread_mutex_unlock(&mutexRegistro);
+}
+
+/**
+ * @brief Desconecta las sesiones que superaron el tiempo de inactividad.
+ * @details No libera la sesión directamente, porque puede estar en la cola o en manos de un
+ * trabajador: shutdown() hace que epoll la reporte y el trabajador la cierre al fallar la E/S.
+ */
+void ServidorDecodificador::revisarInactivas() {
+    long ahora = segundosActuales();
+    pthread_mutex_lock(&mutexRegistro);
+    for (Sesion* s = registro; s; s = s->siguiente) {
+        if (ahora - s->ultimaActividad >= TIEMPO_INACTIVO) {
+            shutdown(s->fd, SHUT_RDWR);
+        }
+    }
+    pthread_mutex_unlock(&mutexRegistro);
+}
+
+/**
+ * @brief Quita la sesión del registro, cierra su socket y libera su memoria.
+ * @details Cerrar el descriptor también lo retira de epoll.
+ * @param s Sesión a cerrar.
+ */
+void ServidorDecodificador::cerrarSesion(Sesion* s) {
+    pthread_mutex_lock(&mutexRegistro);
+    if (s->anterior) {
+        s->anterior->siguiente = s->siguiente;
+    } else {
+        registro = s->siguiente;
+    }
+    if (s->siguiente) s->siguiente->anterior = s->anterior;
+    sesionesActivas--;
+    pthread_mutex_unlock(&mutexRegistro);
+
+    close(s->fd);
+    delete s;
+}
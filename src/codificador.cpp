@@ -0,0 +1,252 @@
+/**
+ * @file codificador.cpp
+ * @brief Programa principal del codificador PRT-7
+ * @details Lee texto plano (o un flujo PRT-7 con -c) desde la entrada estándar y escribe en la
+ * salida estándar el flujo de tramas más corto que el decodificador ensambla como ese mensaje.
+ *
+ * Uso: codificadorprt7 [-c] [-d inicial] [-f final | -p] [-s] [-v] < entrada > salida
+ * - -c: la entrada es un flujo PRT-7 que se comprime en lugar de texto plano.
+ * - -d: desplazamiento del rotor del decodificador al empezar (0 por defecto).
+ * - -f: deja el rotor en este desplazamiento al terminar, con una única trama M.
+ * - -p: con -c, deja el rotor en el mismo desplazamiento que el flujo original.
+ * - -s: no agrega la trama "FIN" al final.
+ * - -v: decodifica el resultado con RotorDeMapeo y ListaDeCarga y lo compara con el mensaje esperado.
+ */
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include "CodificadorPRT7.h"
+#include "ParserTramas.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+
+static const size_t TAM_BLOQUE = 64 * 1024; ///< Caracteres de texto procesados por bloque
+
+/**
+ * @class Verificador
+ * @brief Decodifica un flujo con las mismas estructuras que el decodificador para comprobar el resultado
+ * @details El mensaje se extrae por partes para no mantener en memoria una lista del tamaño de toda la entrada.
+ */
+class Verificador {
+private:
+    RotorDeMapeo rotor;  ///< Disco de cifrado del decodificador simulado
+    ListaDeCarga* carga; ///< Caracteres decodificados desde la última extracción
+    char linea[256];     ///< Línea parcial pendiente de completar
+    int lenLinea;        ///< Caracteres acumulados en linea
+
+public:
+    Verificador(int desplazamiento) : carga(new ListaDeCarga()), lenLinea(0) {
+        rotor.rotar(desplazamiento);
+    }
+
+    /**
+     * @brief Procesa un fragmento del flujo, que puede cortar líneas a la mitad
+     * @param datos Bytes del flujo
+     * @param n Cantidad de bytes
+     */
+    void consumir(const char* datos, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            if (datos[i] == '\n' || lenLinea == 255) {
+                linea[lenLinea] = '\0';
+                lenLinea = 0;
+                if (std::strcmp(linea, "FIN") == 0) continue;
+                TramaBase* trama = parsearTrama(linea, false);
+                if (trama) {
+                    trama->aplicar(carga, &rotor);
+                    delete trama;
+                }
+            }
+            if (datos[i] != '\n' && datos[i] != '\r') {
+                linea[lenLinea++] = datos[i];
+            }
+        }
+    }
+
+    /**
+     * @brief Cantidad de caracteres decodificados pendientes de extraer
+     * @return Longitud del mensaje parcial
+     */
+    int pendientes() const { return carga->getLongitud(); }
+
+    /**
+     * @brief Copia el mensaje parcial y vacía la lista
+     * @param destino Búfer con al menos pendientes() + 1 bytes
+     */
+    void extraer(char* destino) {
+        carga->copiarMensaje(destino);
+        delete carga;
+        carga = new ListaDeCarga();
+    }
+
+    /**
+     * @brief Desplazamiento actual del rotor simulado
+     * @return Desplazamiento en el rango 0..25
+     */
+    int getDesplazamiento() { return rotor.getMapeo('A') - 'A'; }
+
+    ~Verificador() { delete carga; }
+};
+
+/**
+ * @brief Escribe un búfer completo en la salida estándar
+ * @param datos Bytes a escribir
+ * @param n Cantidad de bytes
+ * @return false si ocurrió un error de escritura
+ */
+static bool escribir(const char* datos, size_t n) {
+    return std::fwrite(datos, 1, n, stdout) == n;
+}
+
+/**
+ * @brief Compara el mensaje esperado con lo que decodificó el verificador y vacía ambos
+ * @param esperado Verificador del flujo original, o nullptr si se compara con texto
+ * @param texto Texto esperado cuando esperado es nullptr
+ * @param lenTexto Longitud de texto
+ * @param obtenido Verificador del flujo generado
+ * @return true si ambos mensajes coinciden
+ */
+static bool coincide(Verificador* esperado, const char* texto, size_t lenTexto, Verificador& obtenido) {
+    char* bufEsperado = nullptr;
+    if (esperado) {
+        lenTexto = esperado->pendientes();
+        bufEsperado = new char[lenTexto + 1];
+        esperado->extraer(bufEsperado);
+        texto = bufEsperado;
+    }
+
+    size_t lenObtenido = obtenido.pendientes();
+    char* bufObtenido = new char[lenObtenido + 1];
+    obtenido.extraer(bufObtenido);
+
+    bool iguales = lenObtenido == lenTexto && std::memcmp(bufObtenido, texto, lenTexto) == 0;
+    delete[] bufObtenido;
+    delete[] bufEsperado;
+    return iguales;
+}
+
+int main(int argc, char* argv[]) {
+    bool comprimir = false;
+    bool conFin = true;
+    bool verificar = false;
+    bool preservar = false;
+    bool conFinal = false;
+    int inicial = 0;
+    int desplazamientoFinal = 0;
+
+    int opcion;
+    while ((opcion = getopt(argc, argv, "cd:f:psv")) != -1) {
+        switch (opcion) {
+            case 'c': comprimir = true; break;
+            case 'd': inicial = std::atoi(optarg); break;
+            case 'f': desplazamientoFinal = std::atoi(optarg); conFinal = true; break;
+            case 'p': preservar = true; break;
+            case 's': conFin = false; break;
+            case 'v': verificar = true; break;
+            default:
+                std::cerr << "Uso: " << argv[0] << " [-c] [-d inicial] [-f final | -p] [-s] [-v]" << std::endl;
+                return 1;
+        }
+    }
+    if (preservar && !comprimir) {
+        std::cerr << "[ERROR] -p solo tiene sentido junto con -c" << std::endl;
+        return 1;
+    }
+
+    CodificadorPRT7 codificador(inicial);
+    Verificador* vEntrada = (verificar && comprimir) ? new Verificador(inicial) : nullptr;
+    Verificador* vSalida = verificar ? new Verificador(inicial) : nullptr;
+    bool correcto = true;
+
+    char* texto = new char[TAM_BLOQUE];
+    char* salida = new char[CodificadorPRT7::capacidadNecesaria(TAM_BLOQUE)];
+    char* filtrado = verificar ? new char[TAM_BLOQUE] : nullptr;
+
+    if (comprimir) {
+        // Flujo existente: una trama por línea hasta "FIN"
+        char linea[256];
+        size_t lenSalida = 0;
+        int lineas = 0;
+        while (std::fgets(linea, sizeof(linea), stdin)) {
+            size_t len = std::strcspn(linea, "\r\n");
+            linea[len] = '\0';
+            if (std::strcmp(linea, "FIN") == 0) break;
+
+            lenSalida += codificador.comprimirLinea(linea, salida + lenSalida);
+            if (vEntrada) {
+                vEntrada->consumir(linea, len);
+                vEntrada->consumir("\n", 1);
+            }
+            if (++lineas == (int)TAM_BLOQUE) {
+                if (vSalida) {
+                    vSalida->consumir(salida, lenSalida);
+                    if (!coincide(vEntrada, nullptr, 0, *vSalida)) correcto = false;
+                }
+                if (!escribir(salida, lenSalida)) break;
+                lenSalida = 0;
+                lineas = 0;
+            }
+        }
+        if (vSalida) {
+            vSalida->consumir(salida, lenSalida);
+            if (!coincide(vEntrada, nullptr, 0, *vSalida)) correcto = false;
+        }
+        escribir(salida, lenSalida);
+    } else {
+        // Texto plano: camino rápido por bloques
+        size_t n;
+        while ((n = std::fread(texto, 1, TAM_BLOQUE, stdin)) > 0) {
+            size_t lenSalida = codificador.codificar(texto, n, salida);
+            if (vSalida) {
+                size_t lenFiltrado = 0;
+                for (size_t i = 0; i < n; i++) {
+                    if (texto[i] != '\n' && texto[i] != '\r' && texto[i] != '\0') {
+                        filtrado[lenFiltrado++] = texto[i];
+                    }
+                }
+                vSalida->consumir(salida, lenSalida);
+                if (!coincide(nullptr, filtrado, lenFiltrado, *vSalida)) correcto = false;
+            }
+            if (!escribir(salida, lenSalida)) break;
+        }
+    }
+
+    // Cierre del flujo: giro final opcional y trama de fin
+    if (preservar) {
+        desplazamientoFinal = codificador.getDesplazamientoEntrada();
+        conFinal = true;
+    }
+    size_t lenCierre = conFinal ? codificador.rotarA(desplazamientoFinal, salida) : 0;
+    if (conFin) {
+        std::memcpy(salida + lenCierre, "FIN\n", 4);
+        lenCierre += 4;
+    }
+    if (vSalida) {
+        vSalida->consumir(salida, lenCierre);
+        if (vSalida->getDesplazamiento() != codificador.getDesplazamiento()) {
+            correcto = false;
+        }
+    }
+    escribir(salida, lenCierre);
+    std::fflush(stdout);
+
+    if (codificador.getOmitidos() > 0) {
+        std::cerr << "[INFO] " << codificador.getOmitidos() << " caracteres omitidos (saltos de línea o nulos)" << std::endl;
+    }
+    if (verificar) {
+        if (correcto) {
+            std::cerr << "[OK] Verificación correcta: el flujo se decodifica como el mensaje original" << std::endl;
+        } else {
+            std::cerr << "[ERROR] Verificación fallida: el flujo no reproduce el mensaje original" << std::endl;
+        }
+    }
+
+    delete[] filtrado;
+    delete[] salida;
+    delete[] texto;
+    delete vSalida;
+    delete vEntrada;
+
+    return correcto ? 0 : 1;
+}
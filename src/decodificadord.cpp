@@ -0,0 +1,64 @@
+/**
+ * @file decodificadord.cpp
+ * @brief Programa principal del servicio de decodificación PRT-7
+ * @details Atiende sesiones de decodificación concurrentes sobre un socket de dominio Unix,
+ * sin reiniciar el proceso ni el Arduino por cada trabajo.
+ *
+ * Uso: decodificadord [ruta_socket] [hilos]
+ */
+#include <iostream>
+#include <cstdlib>
+#include <csignal>
+#include <unistd.h>
+#include <sys/resource.h>
+#include "ServidorDecodificador.h"
+
+static ServidorDecodificador* servidor = nullptr; ///< Servidor activo, usado por el manejador de señales
+
+/**
+ * @brief Manejador de SIGINT/SIGTERM: solicita una parada ordenada del servidor.
+ * @param senal Número de la señal recibida (no se utiliza).
+ */
+static void manejarSenal(int senal) {
+    (void)senal;
+    if (servidor) servidor->detener();
+}
+
+int main(int argc, char* argv[]) {
+    const char* ruta = (argc > 1) ? argv[1] : "/tmp/prt7.sock";
+    int hilos = (argc > 2) ? std::atoi(argv[2]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (hilos < 1) hilos = 1;
+
+    std::cout << "   Iniciando Servicio Decodificador PRT-7\n";
+
+    // Cada sesión ocupa un descriptor: subir el límite blando hasta el máximo permitido
+    struct rlimit limite;
+    if (getrlimit(RLIMIT_NOFILE, &limite) == 0 && limite.rlim_cur < limite.rlim_max) {
+        limite.rlim_cur = limite.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limite);
+    }
+
+    servidor = new ServidorDecodificador(ruta, hilos);
+    if (!servidor->estaEscuchando()) {
+        std::cerr << "[ERROR] No se pudo iniciar el servidor." << std::endl;
+        delete servidor;
+        return 1;
+    }
+
+    struct sigaction accion;
+    accion.sa_handler = manejarSenal;
+    sigemptyset(&accion.sa_mask);
+    accion.sa_flags = 0;
+    sigaction(SIGINT, &accion, nullptr);
+    sigaction(SIGTERM, &accion, nullptr);
+
+    servidor->ejecutar();
+
+    std::cout << "Liberando memoria... ";
+    ServidorDecodificador* temp = servidor;
+    servidor = nullptr;
+    delete temp;
+    std::cout << "Sistema apagado.\n";
+
+    return 0;
+}
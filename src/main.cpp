@@ -5,50 +5,11 @@
  */
 #include <iostream>
 #include <cstring>
-#include <cstdlib>
 #include "ArduinoSerial.h"
 #include "TramaBase.h"
 #include "ListaDeCarga.h"
 #include "RotorDeMapeo.h"
-
-/**
- * @brief Parsea una línea del serial y crea la trama correspondiente
- * @param linea Cadena recibida del serial (ej. "L,A" o "M,5")
- * @return Puntero a TramaBase (TramaLoad o TramaMap) o nullptr si hay error
- */
-TramaBase* parsearTrama(const char* linea) {
-    if (!linea || linea[0] == '\0') {
-        return nullptr;
-    }
-    
-    // Verificar formato mínimo: "X,Y"
-    if (std::strlen(linea) < 3 || linea[1] != ',') {
-        std::cerr << "[ERROR] Trama mal formada: " << linea << std::endl;
-        return nullptr;
-    }
-    
-    char tipo = linea[0];
-    
-    if (tipo == 'L') {
-        // Trama de carga: L,X donde X es un carácter
-        const char* dato = &linea[2];
-        if (std::strcmp(dato, "Space") == 0) {
-            std::cout << "[INFO] Trama especial L,Space recibida.\n";
-            return new TramaLoad(' '); // Crea una TramaLoad con el carácter espacio
-        }
-        char caracter = linea[2];
-        return new TramaLoad(caracter);
-    } 
-    else if (tipo == 'M') {
-        // Trama de mapeo: M,N donde N es un entero
-        int rotacion = std::atoi(&linea[2]);
-        return new TramaMap(rotacion);
-    } 
-    else {
-        std::cerr << "[ERROR] Tipo de trama desconocido: " << tipo << std::endl;
-        return nullptr;
-    }
-}
+#include "ParserTramas.h"
 
 int main() {
     std::cout << "   Iniciando Decodificador\n";